@@ -12,6 +12,9 @@ const AlgoTable kSortAlgorithms = {
     {"Heap Sort", HeapSort},
     {"Insertion Sort", InsertionSort},
     {"Merge Sort", MergeSort},
+    {"Network Merge Sort", NetworkMergeSort},
+    {"Network Quick Sort", NetworkQuickSort},
+    {"Network Tim Sort", NetworkTimSort},
     {"Odd-Even Sort", OddEvenSort},
     {"Quick Sort", QuickSort},
     {"Selection Sort", SelectionSort},
@@ -21,6 +24,48 @@ const AlgoTable kSortAlgorithms = {
     {"Tree Sort", TreeSort}
 };
 
+/*
+ * Standard library sorts (implemented below) that every algorithm above is
+ * compared against, so the ranking shows how good the winner actually is
+ */
+const string kStdSortName = "std::sort";
+const AlgoTable kReferenceAlgorithms = {
+    {"std::make_heap + std::sort_heap", StdHeapSort},
+    {kStdSortName, StdSort},
+#ifdef SORTCOMPARER_HAVE_TBB
+    {"std::sort (par_unseq)", StdSortParUnseq},
+#endif
+    {"std::stable_sort", StdStableSort}
+};
+
+/*
+ * Number of timed runs every algorithm and the bandwidth floor are the best of
+ */
+const int kTimedRuns = 3;
+
+/*
+ * Number of elements the reference algorithms are warmed up on
+ */
+const size_t kWarmUpSize = 1024;
+
+/*
+ * Size of the buffer written before each run under the cold cache policy,
+ * chosen to be larger than the last-level cache of common CPUs
+ */
+const size_t kEvictionBufferBytes = 64 * 1024 * 1024;
+const size_t kCacheLineBytes = 64;
+
+/*
+ * Range size at or below which the network variants of the recursive sorts
+ * switch to a sorting network (see --base-case-sweep to tune it per CPU)
+ */
+const size_t kNetworkCutoff = 16;
+
+/*
+ * Number of runs each cell of --base-case-sweep is the best of
+ */
+const int kSweepRepetitions = 5;
+
 /****************************** SORT ALGORITHMS ******************************/
 
 /**
@@ -32,7 +77,7 @@ const AlgoTable kSortAlgorithms = {
  * last position, then the second-largest element to the second-last position,
  * and so on.
  */
-void BubbleSort (vector<long>& values, size_t N) {
+void BubbleSort (SortBuffer& values, size_t N) {
     for (int k = N - 1; k >= 0; --k)
         for (int i = 0; i < k; ++i)
             if (values[i] > values[i + 1])
@@ -49,7 +94,7 @@ void BubbleSort (vector<long>& values, size_t N) {
  * the smallest element to the beginning, second-largest element to position
  * second from the end, and so on until values is fully sorted.
  */
-void CocktailSort (vector<long>& values, size_t N) {
+void CocktailSort (SortBuffer& values, size_t N) {
     bool swapOccurred(true);
     size_t start(0), finish(N - 1);
 
@@ -91,7 +136,7 @@ void CocktailSort (vector<long>& values, size_t N) {
  * bring very out-of-place elements closer to their final sorted position using
  * fewer overall swaps, improving performance.
  */
-void CombSort (vector<long>& values, size_t N) {
+void CombSort (SortBuffer& values, size_t N) {
     bool swapOccurred = true;
     size_t gap = N;
 
@@ -120,7 +165,7 @@ void CombSort (vector<long>& values, size_t N) {
  * position, and so on until we are back to the cycle start. Then advance to
  * find the next cycle, and so on until fully sorted.
  */
-void CycleSort (vector<long>& values, size_t N) {
+void CycleSort (SortBuffer& values, size_t N) {
     for (size_t cycStart = 0; cycStart < N - 1; ++cycStart) {
         long item = values[cycStart];
         size_t pos = cycStart;
@@ -167,7 +212,7 @@ void CycleSort (vector<long>& values, size_t N) {
  * and step backward. If there is no previous element then step forward, if
  * we're at the end and no swap is necessary then we are done.
  */
-void GnomeSort (vector<long>& values, size_t N) {
+void GnomeSort (SortBuffer& values, size_t N) {
     size_t pos = 0;
     while (pos < N) {
         if (pos == 0)
@@ -189,7 +234,7 @@ void GnomeSort (vector<long>& values, size_t N) {
  * Build a max heap on values, move the max element to "sorted" end of the
  * array, then reheapify and repeat the process until fully sorted.
  */
-void HeapSort (vector<long>& values, size_t N) {
+void HeapSort (SortBuffer& values, size_t N) {
     // Build initial max heap
     for (int i = N / 2 - 1; i >= 0; --i)
         Heapify(values, N, i);
@@ -209,7 +254,7 @@ void HeapSort (vector<long>& values, size_t N) {
  * place each "unsorted" element in its proper position in the sorted portion of
  * values, until the values is fully sorted.
  */
-void InsertionSort (vector<long>& values, size_t N) {
+void InsertionSort (SortBuffer& values, size_t N) {
     InsertionSortInRange(values, 0, N - 1);
 }
 
@@ -222,10 +267,47 @@ void InsertionSort (vector<long>& values, size_t N) {
  * one element in each of the two subarrays left), then merge the two
  * subarrays into one sorted array, and so on until values is fully sorted.
  */
-void MergeSort (vector<long>& values, size_t N) {
+void MergeSort (SortBuffer& values, size_t N) {
     MergeSortInRange(values, 0, N - 1);
 }
 
+/**
+ * NETWORK MERGE SORT
+ * Time Complexity: O(nlogn)
+ * Space Complexity: O(n)
+ *
+ * Merge sort which stops dividing once a subarray holds at most kNetworkCutoff
+ * elements, and sorts it with a branchless sorting network instead.
+ */
+void NetworkMergeSort (SortBuffer& values, size_t N) {
+    MergeSortInRange(values, 0, N - 1, {SortingNetworkInRange, kNetworkCutoff});
+}
+
+/**
+ * NETWORK QUICK SORT
+ * Time Complexity: O(n^2) worst case, O(nlogn) on average
+ * Space Complexity: O(logn), in call stack space
+ *
+ * Quick sort which stops partitioning once a partition holds at most
+ * kNetworkCutoff elements, and sorts it with a branchless sorting network
+ * instead.
+ */
+void NetworkQuickSort (SortBuffer& values, size_t N) {
+    QuickSortInRange(values, 0, N - 1, {SortingNetworkInRange, kNetworkCutoff});
+}
+
+/**
+ * NETWORK TIM SORT
+ * Time Complexity: O(nlogn)
+ * Space Complexity: O(n)
+ *
+ * Tim sort whose runs of size 32 are sorted with a branchless sorting network
+ * rather than insertion sort.
+ */
+void NetworkTimSort (SortBuffer& values, size_t N) {
+    TimSortWithBaseCase(values, N, {SortingNetworkInRange, kMaxNetworkSize});
+}
+
 /**
  * ODD-EVEN SORT
  * Time Complexity: O(n^2)
@@ -234,7 +316,7 @@ void MergeSort (vector<long>& values, size_t N) {
  * Variation on bubble sort which bubbles up one odd-indexed element, then one
  * even-indexed element on each pass, repeating until fully sorted.
  */
-void OddEvenSort (vector<long>& values, size_t N) {
+void OddEvenSort (SortBuffer& values, size_t N) {
     const vector<size_t> kStartIndices = {1, 0};
     bool isSorted = false;
     while (!isSorted) {
@@ -259,7 +341,7 @@ void OddEvenSort (vector<long>& values, size_t N) {
  * selected pivot element (value at median index in range will beused here),
  * then recursively quick sort each partition until values is fully sorted.
  */
-void QuickSort (vector<long>& values, size_t N) {
+void QuickSort (SortBuffer& values, size_t N) {
     QuickSortInRange(values, 0, N - 1);
 }
 
@@ -272,7 +354,7 @@ void QuickSort (vector<long>& values, size_t N) {
  * for the minimum element remaining in the unsorted part of the list, then
  * move it to the end of the sorted portion. Repeat until fully sorted.
  */
-void SelectionSort (vector<long>& values, size_t N) {
+void SelectionSort (SortBuffer& values, size_t N) {
     for (int i = 0; i < N - 1; ++i) {
         int minIdx = i;
         for (int j = i + 1; j < N; ++j)
@@ -298,7 +380,7 @@ void SelectionSort (vector<long>& values, size_t N) {
  * and has been found to be among the best performing ones for Shell Sort in
  * practice (no one knows why).
  */
-void ShellSort (vector<long>& values, size_t N) {
+void ShellSort (SortBuffer& values, size_t N) {
     size_t gap = N;
     while (gap != 1) {
         gap = max(static_cast<size_t>(1), static_cast<size_t>((gap - 1) / 2.25));
@@ -317,11 +399,11 @@ void ShellSort (vector<long>& values, size_t N) {
  * elements from input as they are added to a strand, then merge them together
  * one-by-one to create a fully sorted output list.
  */
-void StrandSort (vector<long>& values, size_t N) {
+void StrandSort (SortBuffer& values, size_t N) {
     list<long> inList, outList;
     inList.assign(begin(values), end(values));
     ExtractAndMergeStrand(inList, outList);
-    values.assign(begin(outList), end(outList));
+    copy(begin(outList), end(outList), begin(values));
 }
 
 /**
@@ -333,21 +415,8 @@ void StrandSort (vector<long>& values, size_t N) {
  * insertion sort, merge the runs together into sorted subarrays of size 64,
  * and so on until all of values is sorted.
  */
-void TimSort (vector<long>& values, size_t N) {
-    // Sort individual runs of elements using insertion sort
-    const size_t kRun = 32;
-    for (size_t i = 0; i < N; i += kRun)
-        InsertionSortInRange(values, i, min(i + kRun - 1, N - 1));
-
-    // Merge sorted runs together until entire array is sorted
-    for (size_t size = kRun; size < N; size *= 2) {
-        for (size_t l = 0; l < N; l += size * 2) {
-            size_t m = l + size - 1;
-            size_t r = min(l + size * 2 - 1, N - 1);
-            if (m < r)
-                MergeSortedSubarrays(values, l, m, r);
-        }
-    }
+void TimSort (SortBuffer& values, size_t N) {
+    TimSortWithBaseCase(values, N, {InsertionSortInRange, 32});
 }
 
 /**
@@ -358,7 +427,7 @@ void TimSort (vector<long>& values, size_t N) {
  * Insert all elements in values into a (balanced) binary search tree, then
  * overwriting values array with the inorder traversal of this tree.
  */
-void TreeSort (vector<long>& values, size_t N) {
+void TreeSort (SortBuffer& values, size_t N) {
     multiset<long> tree;
     for (const long elem : values)
         tree.insert(elem);
@@ -367,6 +436,45 @@ void TreeSort (vector<long>& values, size_t N) {
         values[idx++] = *iter;
 }
 
+/**************************** REFERENCE ALGORITHMS ****************************/
+
+/**
+ * STD HEAP SORT
+ * Build a max heap on values with std::make_heap, then sort it in place with
+ * std::sort_heap.
+ */
+void StdHeapSort (SortBuffer& values, size_t N) {
+    make_heap(begin(values), begin(values) + N);
+    sort_heap(begin(values), begin(values) + N);
+}
+
+/**
+ * STD SORT
+ * The standard library's unstable sort (introsort in common implementations).
+ */
+void StdSort (SortBuffer& values, size_t N) {
+    sort(begin(values), begin(values) + N);
+}
+
+/**
+ * STD SORT (PAR_UNSEQ)
+ * The standard library's unstable sort, allowed to run in parallel and
+ * vectorized via the std::execution::par_unseq policy.
+ */
+#ifdef SORTCOMPARER_HAVE_TBB
+void StdSortParUnseq (SortBuffer& values, size_t N) {
+    sort(std::execution::par_unseq, begin(values), begin(values) + N);
+}
+#endif
+
+/**
+ * STD STABLE SORT
+ * The standard library's stable sort (merge sort in common implementations).
+ */
+void StdStableSort (SortBuffer& values, size_t N) {
+    stable_sort(begin(values), begin(values) + N);
+}
+
 /*************************** SORT ALGORITHM HELPERS ***************************/
 
 /**
@@ -406,7 +514,7 @@ void ExtractAndMergeStrand (list<long>& inList, list<long>& outList) {
  * at i by repeatedly finding the max value among i and its children, then
  * move largest value to i and recursively heapify child subtree if necessary.
  */
-void Heapify (vector<long>& values, size_t N, int i) {
+void Heapify (SortBuffer& values, size_t N, int i) {
     // Find largest value among element at i and its children in the heap
     int largest(i), left(2 * i + 1), right(2 * i + 2);
     if (left < N && values[left] > values[largest])
@@ -425,20 +533,26 @@ void Heapify (vector<long>& values, size_t N, int i) {
  * Helper function for InsertionSort() and TimSort(). Perform an insertion sort
  * on range values[l..r].
  */
-void InsertionSortInRange (vector<long>& values, size_t l, size_t r) {
+void InsertionSortInRange (SortBuffer& values, size_t l, size_t r) {
     for (size_t i = l + 1; i <= r; ++i)
         for (size_t j = i; j > l && values[j - 1] > values[j]; --j)
             swap(values[j], values[j - 1]);
 }
 
 /**
- * Helper function for MergeSort(). Perform a merge sort on range values[l..r].
+ * Helper function for MergeSort() and NetworkMergeSort(). Perform a merge sort
+ * on range values[l..r], handing ranges of at most baseCase.cutoff elements to
+ * baseCase.sort if one is given.
  */
-void MergeSortInRange (vector<long>& values, size_t l, size_t r) {
+void MergeSortInRange (SortBuffer& values, size_t l, size_t r, BaseCase baseCase) {
     if (l < r) {
+        if (baseCase.sort && r - l + 1 <= baseCase.cutoff) {
+            baseCase.sort(values, l, r);
+            return;
+        }
         size_t m = l + (r - l) / 2;
-        MergeSortInRange(values, l, m);
-        MergeSortInRange(values, m + 1, r);
+        MergeSortInRange(values, l, m, baseCase);
+        MergeSortInRange(values, m + 1, r, baseCase);
         MergeSortedSubarrays(values, l, m, r);
     }
 }
@@ -447,7 +561,7 @@ void MergeSortInRange (vector<long>& values, size_t l, size_t r) {
  * Helper function for MergeSort() and TimSort(). Merge two (already sorted)
  * subarrays values[l..m] and values[(m+1)..r] to sort range values[l..r].
  */
-void MergeSortedSubarrays (vector<long>& values, size_t l, size_t m, size_t r) {
+void MergeSortedSubarrays (SortBuffer& values, size_t l, size_t m, size_t r) {
     size_t sizeA = m - l + 1;
     size_t sizeB = r - m;
     long A[sizeA], B[sizeB];
@@ -475,10 +589,17 @@ void MergeSortedSubarrays (vector<long>& values, size_t l, size_t m, size_t r) {
 
 
 /**
- * Helper function for QuickSort(). Performs quick sort on range values[l..r].
+ * Helper function for QuickSort() and NetworkQuickSort(). Performs quick sort
+ * on range values[l..r], handing ranges of at most baseCase.cutoff elements to
+ * baseCase.sort if one is given.
  */
-void QuickSortInRange (vector<long>& values, long long l, long long r) {
+void QuickSortInRange (SortBuffer& values, long long l, long long r, BaseCase baseCase) {
     if (l < r) {
+        if (baseCase.sort && static_cast<size_t>(r - l + 1) <= baseCase.cutoff) {
+            baseCase.sort(values, l, r);
+            return;
+        }
+
         // Select median index in range as pivot
         size_t pivotIdx = l + (r - l) / 2;
 
@@ -495,13 +616,74 @@ void QuickSortInRange (vector<long>& values, long long l, long long r) {
         swap(values[i + 1], values[r]);
 
         // Recursively quick sort each partition
-        QuickSortInRange(values, l, i);
-        QuickSortInRange(values, i + 2, r);
+        QuickSortInRange(values, l, i, baseCase);
+        QuickSortInRange(values, i + 2, r, baseCase);
+    }
+}
+
+/**
+ * Helper function for the network sort variants. Sort range values[l..r],
+ * which must hold at most kMaxNetworkSize elements, with the sorting network
+ * of matching size.
+ */
+void SortingNetworkInRange (SortBuffer& values, size_t l, size_t r) {
+    assert(r - l + 1 <= kMaxNetworkSize);
+    kSortingNetworks[r - l + 1](&values[l]);
+}
+
+/**
+ * Helper function for TimSort() and NetworkTimSort(). Divide values into runs
+ * of runSort.cutoff elements, sort each run with runSort.sort, then merge the
+ * runs together until all of values is sorted.
+ */
+void TimSortWithBaseCase (SortBuffer& values, size_t N, BaseCase runSort) {
+    // Sort individual runs of elements
+    const size_t kRun = runSort.cutoff;
+    for (size_t i = 0; i < N; i += kRun)
+        runSort.sort(values, i, min(i + kRun - 1, N - 1));
+
+    // Merge sorted runs together until entire array is sorted
+    for (size_t size = kRun; size < N; size *= 2) {
+        for (size_t l = 0; l < N; l += size * 2) {
+            size_t m = l + size - 1;
+            size_t r = min(l + size * 2 - 1, N - 1);
+            if (m < r)
+                MergeSortedSubarrays(values, l, m, r);
+        }
     }
 }
 
 /****************************** DRIVER FUNCTIONS ******************************/
 
+/**
+ * Parse the command line arguments into options. Return 0 on success, 1 on
+ * error.
+ */
+int ParseOptions (int argc, char* argv[], BenchmarkOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const string arg(argv[i]);
+        if (arg == "--base-case-sweep")
+            options.baseCaseSweep = true;
+        else if (arg == "--huge-pages=none")
+            options.hugePages = HugePagePolicy::None;
+        else if (arg == "--huge-pages=thp")
+            options.hugePages = HugePagePolicy::Transparent;
+        else if (arg == "--huge-pages=explicit")
+            options.hugePages = HugePagePolicy::Explicit;
+        else if (arg == "--cache=warm")
+            options.cache = CachePolicy::Warm;
+        else if (arg == "--cache=cold")
+            options.cache = CachePolicy::Cold;
+        else {
+            cerr << "ERROR: Unknown option " << arg << ", usage: sortcomparer "
+                 << "[--base-case-sweep] [--huge-pages=none|thp|explicit] "
+                 << "[--cache=warm|cold]" << endl;
+            return 1;
+        }
+    }
+    return 0;
+}
+
 /**
  * Read integers from standard input and insert them into values vector.
  * Return 0 on success, 1 on error.
@@ -522,35 +704,137 @@ int ReadInValues (vector<long>& values) {
 }
 
 /**
- * Run each sorting algorithm defined above on (a copy of) the input values,
- * measure their execution times in microseconds, and store them in a min heap
- * ordered on said execution time. Return 0 if all sort algorithms sorted the
- * input properly, 1 if any of them failed.
+ * Measure the memory bandwidth floor for the input: the fastest of kTimedRuns
+ * memcpy passes of the values into a buffer of the same size, in nanoseconds,
+ * each starting from the cache state chosen by the cache policy.
+ * Any sort has to read and write every element at least once, so no sort can
+ * beat this time.
+ */
+unsigned long long MeasureBandwidthFloor (const vector<long>& values,
+                                          SortBuffer& evictionBuffer,
+                                          const BenchmarkOptions& options) {
+    const size_t kBytes = size(values) * sizeof(long);
+    // Source and destination are backed like the working buffer and
+    // prefaulted, so page faults are not part of the timing
+    const WorkingBufferAllocator<long> kAllocator(options.hugePages);
+    SortBuffer source(begin(values), end(values), kAllocator);
+    SortBuffer dest(size(values), 0, kAllocator);
+    unsigned long long floorTimeNs = ~0ULL;
+
+    for (int pass = 0; pass < kTimedRuns; ++pass) {
+        // Start from the same cache state as the sorts do
+        PrepareCaches(source, evictionBuffer, options);
+        auto startTime = high_resolution_clock::now();
+        std::memcpy(dest.data(), source.data(), kBytes);
+        auto finishTime = high_resolution_clock::now();
+        floorTimeNs = min<unsigned long long>(
+            floorTimeNs, duration_cast<nanoseconds>(finishTime - startTime).count());
+    }
+    return max(1ULL, floorTimeNs);
+}
+
+/**
+ * Run each reference algorithm once, untimed, on a small scratch buffer, so
+ * that one-time setup such as starting the thread pool behind the parallel
+ * std::sort does not land inside a timed run.
+ */
+void WarmUpReferenceAlgorithms (const BenchmarkOptions& options) {
+    SortBuffer scratch(kWarmUpSize, 0, WorkingBufferAllocator<long>(options.hugePages));
+    for (auto iter = begin(kReferenceAlgorithms); iter != end(kReferenceAlgorithms); ++iter) {
+        for (size_t i = 0; i < kWarmUpSize; ++i)
+            scratch[i] = kWarmUpSize - i;
+        iter->second(scratch, kWarmUpSize);
+    }
+}
+
+/**
+ * Put the caches in the state chosen by the cache policy before a timed run:
+ * either read through the working buffer so it is cached, or write through
+ * the eviction buffer so that nothing of the working buffer is.
+ */
+void PrepareCaches (const SortBuffer& valuesCopy, SortBuffer& evictionBuffer,
+                    const BenchmarkOptions& options) {
+    if (options.cache == CachePolicy::Cold) {
+        for (size_t i = 0; i < size(evictionBuffer); i += kCacheLineBytes / sizeof(long))
+            ++evictionBuffer[i];
+    } else {
+        long sum(0);
+        for (const long elem : valuesCopy)
+            sum += elem;
+        // Keep the read pass from being optimized away
+        volatile long sink = sum;
+        static_cast<void>(sink);
+    }
+}
+
+/**
+ * Run each sorting algorithm and reference algorithm defined above on (a copy
+ * of) the input values, measure their best execution times out of kTimedRuns
+ * in nanoseconds, and store them in a min heap ordered on said execution time. Also record the
+ * std::sort time and the memory bandwidth floor in baselines. Return 0 if all
+ * sort algorithms sorted the input properly, 1 if any of them failed.
+ *
+ * Every algorithm sorts in the same prefaulted working buffer, which is reset
+ * to the input (timed separately) and has the caches prepared before each run.
+ * The reference algorithms are warmed up first, untimed.
  */
-int RunSortAlgorithms (const vector<long>& values, AlgoMinHeap& sortAlgoMinHeap) {
+int RunSortAlgorithms (const vector<long>& values, AlgoMinHeap& sortAlgoMinHeap,
+                       Baselines& baselines, const BenchmarkOptions& options) {
     high_resolution_clock::time_point startTime, finishTime;
-    unsigned long long execTimeUs;
-    vector<long> valuesCopy;
-
-    for (auto iter = begin(kSortAlgorithms); iter != end(kSortAlgorithms); ++iter) {
-        // Create copy of values to sort
-        valuesCopy.assign(begin(values), end(values));
-        cout << "Running " << iter->first << "...";
-
-        // Execute sorting algorithm here
-        startTime = high_resolution_clock::now();
-        iter->second(valuesCopy, size(valuesCopy));
-        finishTime = high_resolution_clock::now();
-
-        // Verify that output of algorithm is sorted
-        if (!is_sorted(begin(valuesCopy), end(valuesCopy))) {
-            cerr << "ERROR: " << iter->first << " did not sort properly" << endl;
-            return 1;
-        }
+    unsigned long long execTimeNs, resetTimeNs;
+    const WorkingBufferAllocator<long> kAllocator(options.hugePages);
+    SortBuffer valuesCopy(size(values), 0, kAllocator);
+    SortBuffer evictionBuffer(kAllocator);
+    if (options.cache == CachePolicy::Cold)
+        evictionBuffer.resize(kEvictionBufferBytes / sizeof(long));
+    const long* kBufferStart = valuesCopy.data();
+
+    baselines.numElements = size(values);
+    baselines.bandwidthFloorTime = MeasureBandwidthFloor(values, evictionBuffer, options);
+    WarmUpReferenceAlgorithms(options);
+
+    for (const bool isReference : {false, true}) {
+        const AlgoTable& algorithms = isReference ? kReferenceAlgorithms : kSortAlgorithms;
+        for (auto iter = begin(algorithms); iter != end(algorithms); ++iter) {
+            cout << "Running " << iter->first << "...";
+            execTimeNs = resetTimeNs = ~0ULL;
+
+            for (int run = 0; run < kTimedRuns; ++run) {
+                // Reset working buffer to the input values
+                startTime = high_resolution_clock::now();
+                copy(begin(values), end(values), begin(valuesCopy));
+                finishTime = high_resolution_clock::now();
+                resetTimeNs = min<unsigned long long>(
+                    resetTimeNs, duration_cast<nanoseconds>(finishTime - startTime).count());
+                PrepareCaches(valuesCopy, evictionBuffer, options);
+
+                // Execute sorting algorithm here
+                startTime = high_resolution_clock::now();
+                iter->second(valuesCopy, size(valuesCopy));
+                finishTime = high_resolution_clock::now();
+
+                // Verify that algorithm sorted in place in the working buffer
+                if (valuesCopy.data() != kBufferStart || size(valuesCopy) != size(values)) {
+                    cerr << "ERROR: " << iter->first << " reallocated the working buffer" << endl;
+                    return 1;
+                }
+
+                // Verify that output of algorithm is sorted
+                if (!is_sorted(begin(valuesCopy), end(valuesCopy))) {
+                    cerr << "ERROR: " << iter->first << " did not sort properly" << endl;
+                    return 1;
+                }
 
-        cout << " Done." << endl;
-        execTimeUs = duration_cast<microseconds>(finishTime - startTime).count();
-        sortAlgoMinHeap.emplace(AlgoWithTime{iter->first, execTimeUs});
+                execTimeNs = min<unsigned long long>(
+                    execTimeNs, duration_cast<nanoseconds>(finishTime - startTime).count());
+            }
+
+            cout << " Done." << endl;
+            execTimeNs = max(1ULL, execTimeNs);
+            if (isReference && iter->first == kStdSortName)
+                baselines.stdSortTime = execTimeNs;
+            sortAlgoMinHeap.emplace(AlgoWithTime{iter->first, execTimeNs, resetTimeNs, isReference});
+        }
     }
     cout << endl;
     return 0;
@@ -558,31 +842,123 @@ int RunSortAlgorithms (const vector<long>& values, AlgoMinHeap& sortAlgoMinHeap)
 
 /**
  * Print an explanation of the performance results of each sorting algorithm
- * measured, in order from best to worst performing on the given input.
+ * measured, in order from best to worst performing on the given input. Each
+ * algorithm is reported with its throughput in elements per second and in
+ * effective GB per second (counting one read and one write of every element,
+ * the same traffic as the bandwidth floor, however much more the algorithm
+ * actually moves), and its time relative to std::sort and to the bandwidth
+ * floor. The time spent resetting the working buffer to the
+ * input before each run is reported separately and not part of the ranking.
  */
-void PrintResults (AlgoMinHeap& sortAlgoMinHeap) {
+void PrintResults (AlgoMinHeap& sortAlgoMinHeap, const Baselines& baselines) {
+    const double kBytesTouched = 2.0 * baselines.numElements * sizeof(long);
+
     cout << "SORT ALGORITHM PERFORMANCES ON INPUT (IN MICROSECONDS):" << endl;
+    cout << "Effective GB/s counts one read and one write per element" << endl;
+    cout << fixed << setprecision(1) << "Memory bandwidth floor (memcpy): "
+         << baselines.bandwidthFloorTime / 1000.0 << "\u03BCs, " << setprecision(2)
+         << kBytesTouched / baselines.bandwidthFloorTime << " GB/s" << endl;
     int rank(0);
     while (!empty(sortAlgoMinHeap)) {
-        auto [algo, time] = sortAlgoMinHeap.top();
+        auto [algo, time, resetTime, isReference] = sortAlgoMinHeap.top();
         sortAlgoMinHeap.pop();
-        cout << ++rank << ") " << algo << ": " << time << "\u03BCs" << endl;
+        cout << ++rank << ") " << algo << (isReference ? " [reference]" : "") << ": "
+             << setprecision(1) << time / 1000.0 << "\u03BCs, "
+             << setprecision(2) << baselines.numElements * 1000.0 / time << "M elem/s, "
+             << kBytesTouched / time << " effective GB/s, "
+             << static_cast<double>(time) / baselines.stdSortTime << "x std::sort, "
+             << static_cast<double>(time) / baselines.bandwidthFloorTime << "x floor"
+             << " (reset: " << setprecision(1) << resetTime / 1000.0 << "\u03BCs)" << endl;
     }
 }
 
 
+/**
+ * Time merge, quick and tim sort on (a copy of) the input values with an
+ * insertion sort base case versus a sorting network base case, for each
+ * base case size from 2 to kMaxNetworkSize, and print the best of
+ * kSweepRepetitions runs per cell as a table so that the best cutoff for the
+ * current CPU can be picked. Return 0 if every run sorted the input properly,
+ * 1 if any of them failed.
+ */
+int RunBaseCaseSweep (const vector<long>& values, const BenchmarkOptions& options) {
+    const vector<string> kColumns = {
+        "Merge+Ins", "Merge+Net", "Quick+Ins", "Quick+Net", "Tim+Ins", "Tim+Net"
+    };
+    const size_t N = size(values);
+    SortBuffer valuesCopy(N, 0, WorkingBufferAllocator<long>(options.hugePages));
+    SortBuffer evictionBuffer(WorkingBufferAllocator<long>(options.hugePages));
+    if (options.cache == CachePolicy::Cold)
+        evictionBuffer.resize(kEvictionBufferBytes / sizeof(long));
+
+    cout << "BASE CASE SWEEP ON INPUT (IN MICROSECONDS):" << endl;
+    cout << setw(6) << "Cutoff";
+    for (const string& column : kColumns)
+        cout << setw(12) << column;
+    cout << endl;
+
+    for (size_t cutoff = 2; cutoff <= kMaxNetworkSize; ++cutoff) {
+        const BaseCase kInsertion = {InsertionSortInRange, cutoff};
+        const BaseCase kNetwork = {SortingNetworkInRange, cutoff};
+        const vector<function<void(SortBuffer&)>> kKernels = {
+            [&](SortBuffer& v) { MergeSortInRange(v, 0, N - 1, kInsertion); },
+            [&](SortBuffer& v) { MergeSortInRange(v, 0, N - 1, kNetwork); },
+            [&](SortBuffer& v) { QuickSortInRange(v, 0, N - 1, kInsertion); },
+            [&](SortBuffer& v) { QuickSortInRange(v, 0, N - 1, kNetwork); },
+            [&](SortBuffer& v) { TimSortWithBaseCase(v, N, kInsertion); },
+            [&](SortBuffer& v) { TimSortWithBaseCase(v, N, kNetwork); }
+        };
+
+        cout << setw(6) << cutoff;
+        for (size_t k = 0; k < size(kKernels); ++k) {
+            unsigned long long bestTimeNs = ~0ULL;
+            for (int rep = 0; rep < kSweepRepetitions; ++rep) {
+                copy(begin(values), end(values), begin(valuesCopy));
+                PrepareCaches(valuesCopy, evictionBuffer, options);
+                auto startTime = high_resolution_clock::now();
+                kKernels[k](valuesCopy);
+                auto finishTime = high_resolution_clock::now();
+
+                // Verify that output of kernel is sorted
+                if (!is_sorted(begin(valuesCopy), end(valuesCopy))) {
+                    cout << endl;
+                    cerr << "ERROR: " << kColumns[k] << " with cutoff " << cutoff
+                         << " did not sort properly" << endl;
+                    return 1;
+                }
+                bestTimeNs = min<unsigned long long>(
+                    bestTimeNs, duration_cast<nanoseconds>(finishTime - startTime).count());
+            }
+            cout << setw(12) << fixed << setprecision(1) << bestTimeNs / 1000.0;
+        }
+        cout << endl;
+    }
+    return 0;
+}
+
 /**
  * Read in a series of integers from standard input, measure the performance
- * of each of the 15 sorting algorithms defined above on the input, and report
- * the results.
+ * of each of the sorting algorithms defined above on the input, and report
+ * the results. With --base-case-sweep, instead report how the recursive sorts
+ * perform across base case sizes and kinds. --huge-pages and --cache pick how
+ * the working buffers are backed and what state the caches are in per run.
  */
-int main() {
+int main(int argc, char* argv[]) {
+    BenchmarkOptions options;
+    if (ParseOptions(argc, argv, options))
+        return 1;
     vector<long> values;
     if (ReadInValues(values))
         return 1;
+    if (options.baseCaseSweep) {
+        if (!empty(values) && RunBaseCaseSweep(values, options))
+            return 1;
+        return 0;
+    }
     AlgoMinHeap sortAlgoMinHeap;
-    if (RunSortAlgorithms(values, sortAlgoMinHeap))
+    Baselines baselines;
+    if (RunSortAlgorithms(values, sortAlgoMinHeap, baselines, options))
         return 1;
-    PrintResults(sortAlgoMinHeap);
+    PrintResults(sortAlgoMinHeap, baselines);
     return 0;
 }
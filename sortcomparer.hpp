@@ -2,9 +2,12 @@
 #define SORTCOMPARER_H_
 
 #include <algorithm>
+#include <cassert>
 #include <chrono>
 #include <cmath>
+#include <cstring>
 #include <functional>
+#include <iomanip>
 #include <iostream>
 #include <list>
 #include <queue>
@@ -13,25 +16,42 @@
 #include <unordered_map>
 #include <vector>
 
+#include "sortingnetworks.hpp"
+// Parallel std::sort needs TBB with libstdc++; the Makefile defines
+// SORTCOMPARER_HAVE_TBB only if a parallel std::sort builds and links
+#ifdef SORTCOMPARER_HAVE_TBB
+#include <execution>
+#endif
+#include "workingbuffer.hpp"
+
 using std::ceil;
 using std::cerr;
 using std::chrono::duration_cast;
 using std::chrono::high_resolution_clock;
 using std::chrono::microseconds;
+using std::chrono::nanoseconds;
 using std::chrono::time_point;
 using std::cin;
+using std::copy;
 using std::copy_n;
 using std::cout;
 using std::endl;
+using std::fixed;
 using std::function;
 using std::greater;
 using std::is_sorted;
 using std::list;
+using std::make_heap;
 using std::max;
 using std::min;
 using std::multiset;
 using std::priority_queue;
+using std::setprecision;
+using std::setw;
 using std::size_t;
+using std::sort;
+using std::sort_heap;
+using std::stable_sort;
 using std::string;
 using std::swap;
 using std::unordered_map;
@@ -39,7 +59,9 @@ using std::vector;
 
 struct AlgoWithTime {
     string algoName;
-    unsigned long long execTime;
+    unsigned long long execTime;   // In nanoseconds
+    unsigned long long resetTime;  // In nanoseconds, copying input to buffer
+    bool isReference;
 
     bool operator> (const AlgoWithTime& other) const {
         return execTime > other.execTime;
@@ -47,39 +69,103 @@ struct AlgoWithTime {
 };
 
 using AlgoMinHeap = priority_queue<AlgoWithTime, vector<AlgoWithTime>, greater<>>;
-using AlgoTable = unordered_map<string, function<void(vector<long>&, size_t)>>;
+using SortBuffer = vector<long, WorkingBufferAllocator<long>>;
+using AlgoTable = unordered_map<string, function<void(SortBuffer&, size_t)>>;
+
+/*
+ * State the caches are put in before each timed run
+ */
+enum class CachePolicy {
+    Warm,  // Working buffer was just read, so it is cached as far as it fits
+    Cold   // A buffer larger than the last-level cache was just written
+};
+
+/*
+ * Benchmark settings chosen on the command line
+ */
+struct BenchmarkOptions {
+    bool baseCaseSweep = false;
+    HugePagePolicy hugePages = HugePagePolicy::None;
+    CachePolicy cache = CachePolicy::Warm;
+};
+
+/*
+ * Reference points every algorithm is measured against in the results
+ */
+struct Baselines {
+    size_t numElements;
+    unsigned long long stdSortTime;         // In nanoseconds
+    unsigned long long bandwidthFloorTime;  // In nanoseconds, memcpy of input
+};
+
+/*
+ * Base case for recursive kernels: once a range holds at most cutoff elements,
+ * it is handed to sort instead of being divided further. A null sort disables
+ * the base case.
+ */
+struct BaseCase {
+    void (*sort)(SortBuffer& values, size_t l, size_t r);
+    size_t cutoff;
+};
+
+const BaseCase kNoBaseCase = {nullptr, 0};
 
 /****************************** SORT ALGORITHMS ******************************/
 
-void BubbleSort (vector<long>& values, size_t N);
-void CocktailSort (vector<long>& values, size_t N);
-void CombSort (vector<long>& values, size_t N);
-void CycleSort (vector<long>& values, size_t N);
-void GnomeSort (vector<long>& values, size_t N);
-void HeapSort (vector<long>& values, size_t N);
-void InsertionSort (vector<long>& values, size_t N);
-void MergeSort (vector<long>& values, size_t N);
-void OddEvenSort (vector<long>& values, size_t N);
-void QuickSort (vector<long>& values, size_t N);
-void SelectionSort (vector<long>& values, size_t N);
-void ShellSort (vector<long>& values, size_t N);
-void StrandSort (vector<long>& values, size_t N);
-void TimSort (vector<long>& values, size_t N);
-void TreeSort (vector<long>& values, size_t N);
+void BubbleSort (SortBuffer& values, size_t N);
+void CocktailSort (SortBuffer& values, size_t N);
+void CombSort (SortBuffer& values, size_t N);
+void CycleSort (SortBuffer& values, size_t N);
+void GnomeSort (SortBuffer& values, size_t N);
+void HeapSort (SortBuffer& values, size_t N);
+void InsertionSort (SortBuffer& values, size_t N);
+void MergeSort (SortBuffer& values, size_t N);
+void NetworkMergeSort (SortBuffer& values, size_t N);
+void NetworkQuickSort (SortBuffer& values, size_t N);
+void NetworkTimSort (SortBuffer& values, size_t N);
+void OddEvenSort (SortBuffer& values, size_t N);
+void QuickSort (SortBuffer& values, size_t N);
+void SelectionSort (SortBuffer& values, size_t N);
+void ShellSort (SortBuffer& values, size_t N);
+void StrandSort (SortBuffer& values, size_t N);
+void TimSort (SortBuffer& values, size_t N);
+void TreeSort (SortBuffer& values, size_t N);
+
+/**************************** REFERENCE ALGORITHMS ****************************/
+
+void StdHeapSort (SortBuffer& values, size_t N);
+void StdSort (SortBuffer& values, size_t N);
+#ifdef SORTCOMPARER_HAVE_TBB
+void StdSortParUnseq (SortBuffer& values, size_t N);
+#endif
+void StdStableSort (SortBuffer& values, size_t N);
 
 /*************************** SORT ALGORITHM HELPERS ***************************/
 
 void ExtractAndMergeStrand (list<long>& inList, list<long>& outList);
-void Heapify (vector<long>& values, size_t N, int i);
-void InsertionSortInRange (vector<long>& values, size_t l, size_t r);
-void MergeSortInRange (vector<long>& values, size_t l, size_t r);
-void MergeSortedSubarrays (vector<long>& values, size_t l, size_t m, size_t r);
-void QuickSortInRange (vector<long>& values, long long l, long long r);
+void Heapify (SortBuffer& values, size_t N, int i);
+void InsertionSortInRange (SortBuffer& values, size_t l, size_t r);
+void MergeSortInRange (SortBuffer& values, size_t l, size_t r,
+                       BaseCase baseCase = kNoBaseCase);
+void MergeSortedSubarrays (SortBuffer& values, size_t l, size_t m, size_t r);
+void QuickSortInRange (SortBuffer& values, long long l, long long r,
+                       BaseCase baseCase = kNoBaseCase);
+void SortingNetworkInRange (SortBuffer& values, size_t l, size_t r);
+void TimSortWithBaseCase (SortBuffer& values, size_t N, BaseCase runSort);
 
 /****************************** DRIVER FUNCTIONS ******************************/
 
+int ParseOptions (int argc, char* argv[], BenchmarkOptions& options);
 int ReadInValues (vector<long>& values);
-int RunSortAlgorithms (const vector<long>& values, AlgoMinHeap& sortAlgoMinHeap);
-void PrintResults (AlgoMinHeap& sortAlgoMinHeap);
+unsigned long long MeasureBandwidthFloor (const vector<long>& values,
+                                          SortBuffer& evictionBuffer,
+                                          const BenchmarkOptions& options);
+void WarmUpReferenceAlgorithms (const BenchmarkOptions& options);
+void PrepareCaches (const SortBuffer& valuesCopy, SortBuffer& evictionBuffer,
+                    const BenchmarkOptions& options);
+int RunSortAlgorithms (const vector<long>& values, AlgoMinHeap& sortAlgoMinHeap,
+                       Baselines& baselines, const BenchmarkOptions& options);
+void PrintResults (AlgoMinHeap& sortAlgoMinHeap, const Baselines& baselines);
+int RunBaseCaseSweep (const vector<long>& values, const BenchmarkOptions& options);
 
 #endif // SORTCOMPARER_H_
@@ -0,0 +1,233 @@
+#ifndef SORTINGNETWORKS_H_
+#define SORTINGNETWORKS_H_
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+/*
+ * Compile-time generated sorting networks for small inputs. Each network is a
+ * fixed sequence of compare-exchange operations built from min/max, so sorting
+ * with one involves no data-dependent branches, unlike insertion sort.
+ *
+ * Up to 16 inputs and at 32 inputs the networks match the best known sizes,
+ * except at 13 inputs (see VisitSmallNetwork()). From 17 to 31 inputs they
+ * are built from those and Batcher's merge step, and use up to about 15% more
+ * comparators than the best known networks (e.g. 82 instead of 71 at 17
+ * inputs, 124 instead of 120 at 24), so a base case sweep above 16
+ * understates what sorting networks can do.
+ */
+
+// Largest input size for which a sorting network is generated
+constexpr std::size_t kMaxNetworkSize = 32;
+
+struct Comparator {
+    std::size_t lo;
+    std::size_t hi;
+};
+
+/*
+ * Best known sorting networks for 9, 10, 12 and 16 inputs (25, 29, 39 and 60
+ * comparators), as listed in Bert Dobbelaere's collection of smallest known
+ * sorting networks
+ */
+constexpr std::array<Comparator, 25> kBestNetwork9 = {{
+    {0, 3}, {1, 7}, {2, 5}, {4, 8}, {0, 7}, {2, 4}, {3, 8}, {5, 6},
+    {0, 2}, {1, 3}, {4, 5}, {7, 8}, {1, 4}, {3, 6}, {5, 7}, {0, 1},
+    {2, 4}, {3, 5}, {6, 8}, {2, 3}, {4, 5}, {6, 7}, {1, 2}, {3, 4},
+    {5, 6}
+}};
+
+constexpr std::array<Comparator, 29> kBestNetwork10 = {{
+    {0, 8}, {1, 9}, {2, 7}, {3, 5}, {4, 6}, {0, 2}, {1, 4}, {5, 8},
+    {7, 9}, {0, 3}, {2, 4}, {5, 7}, {6, 9}, {0, 1}, {3, 6}, {8, 9},
+    {1, 5}, {2, 3}, {4, 8}, {6, 7}, {1, 2}, {3, 5}, {4, 6}, {7, 8},
+    {2, 3}, {4, 5}, {6, 7}, {3, 4}, {5, 6}
+}};
+
+constexpr std::array<Comparator, 39> kBestNetwork12 = {{
+    {0, 8}, {1, 7}, {2, 6}, {3, 11}, {4, 10}, {5, 9}, {0, 1}, {2, 5},
+    {3, 4}, {6, 9}, {7, 8}, {10, 11}, {0, 2}, {1, 6}, {5, 10}, {9, 11},
+    {0, 3}, {1, 2}, {4, 6}, {5, 7}, {8, 11}, {9, 10}, {1, 4}, {3, 5},
+    {6, 8}, {7, 10}, {1, 3}, {2, 5}, {6, 9}, {8, 10}, {2, 3}, {4, 5},
+    {6, 7}, {8, 9}, {4, 6}, {5, 7}, {3, 4}, {5, 6}, {7, 8}
+}};
+
+constexpr std::array<Comparator, 60> kBestNetwork16 = {{
+    {0, 13}, {1, 12}, {2, 15}, {3, 14}, {4, 8}, {5, 6}, {7, 11}, {9, 10},
+    {0, 5}, {1, 7}, {2, 9}, {3, 4}, {6, 13}, {8, 14}, {10, 15}, {11, 12},
+    {0, 1}, {2, 3}, {4, 5}, {6, 8}, {7, 9}, {10, 11}, {12, 13}, {14, 15},
+    {0, 2}, {1, 3}, {4, 10}, {5, 11}, {6, 7}, {8, 9}, {12, 14}, {13, 15},
+    {1, 2}, {3, 12}, {4, 6}, {5, 7}, {8, 10}, {9, 11}, {13, 14},
+    {1, 4}, {2, 6}, {5, 8}, {7, 10}, {9, 13}, {11, 14},
+    {2, 4}, {3, 6}, {9, 12}, {11, 13},
+    {3, 5}, {6, 8}, {7, 9}, {10, 12},
+    {3, 4}, {5, 6}, {7, 8}, {9, 10}, {11, 12},
+    {6, 7}, {8, 9}
+}};
+
+/**
+ * Call visit(offset + lo, offset + hi) for each comparator of the merge step
+ * of Batcher's odd-even merge sort that merges sorted runs of p elements into
+ * sorted runs of 2p elements, on N inputs. Comparators that would touch
+ * positions past N are left out, which is equivalent to padding the input
+ * with +infinity.
+ */
+template <typename Visitor>
+constexpr void VisitBatcherMerge (std::size_t N, std::size_t p, std::size_t offset,
+                                  Visitor visit) {
+    for (std::size_t k = p; k >= 1; k /= 2)
+        for (std::size_t j = k % p; j + k < N; j += 2 * k)
+            for (std::size_t i = 0; i < k && i + j + k < N; ++i)
+                if ((i + j) / (2 * p) == (i + j + k) / (2 * p))
+                    visit(offset + i + j, offset + i + j + k);
+}
+
+/**
+ * Call visit(offset + lo, offset + hi) for each comparator of Batcher's
+ * odd-even merge sort network on N inputs, in the order they are to be
+ * applied. It is the best known network up to 8 inputs.
+ */
+template <typename Visitor>
+constexpr void VisitBatcherNetwork (std::size_t N, std::size_t offset, Visitor visit) {
+    for (std::size_t p = 1; p < N; p *= 2)
+        VisitBatcherMerge(N, p, offset, visit);
+}
+
+/**
+ * Call visit(offset + lo, offset + hi) for each comparator of table that only
+ * touches the first N positions. Dropping the comparators on the top wires of
+ * a sorting network leaves a sorting network on the remaining wires.
+ */
+template <std::size_t M, typename Visitor>
+constexpr void VisitPrunedTable (const std::array<Comparator, M>& table, std::size_t N,
+                                 std::size_t offset, Visitor visit) {
+    for (const Comparator& comparator : table)
+        if (comparator.hi < N)
+            visit(offset + comparator.lo, offset + comparator.hi);
+}
+
+/**
+ * Call visit(offset + lo, offset + hi) for each comparator of the best
+ * network available on N <= 16 inputs: Batcher's up to 8 inputs, otherwise
+ * the smallest table above pruned to N. This matches the best known size for
+ * every N except 13 (46 comparators instead of 45).
+ */
+template <typename Visitor>
+constexpr void VisitSmallNetwork (std::size_t N, std::size_t offset, Visitor visit) {
+    if (N <= 8)
+        VisitBatcherNetwork(N, offset, visit);
+    else if (N <= 9)
+        VisitPrunedTable(kBestNetwork9, N, offset, visit);
+    else if (N <= 10)
+        VisitPrunedTable(kBestNetwork10, N, offset, visit);
+    else if (N <= 12)
+        VisitPrunedTable(kBestNetwork12, N, offset, visit);
+    else
+        VisitPrunedTable(kBestNetwork16, N, offset, visit);
+}
+
+/**
+ * Call visit(lo, hi) for each comparator of the network on 16 < N <= 32
+ * inputs built by sorting the first 16 and remaining N - 16 inputs with small
+ * networks, then merging the two runs with Batcher's merge step.
+ */
+template <typename Visitor>
+constexpr void VisitSplitNetwork (std::size_t N, Visitor visit) {
+    VisitSmallNetwork(16, 0, visit);
+    VisitSmallNetwork(N - 16, 16, visit);
+    VisitBatcherMerge(N, 16, 0, visit);
+}
+
+/**
+ * Call visit(lo, hi) for each comparator of the sorting network used for N
+ * inputs, in the order they are to be applied: the small networks up to 16
+ * inputs, the split network up to 32 inputs where it is smaller than
+ * Batcher's, and Batcher's otherwise.
+ */
+template <typename Visitor>
+constexpr void VisitNetwork (std::size_t N, Visitor visit) {
+    std::size_t splitCount(0), batcherCount(0);
+    if (N > 16 && N <= 32) {
+        VisitSplitNetwork(N, [&splitCount](std::size_t, std::size_t) { ++splitCount; });
+        VisitBatcherNetwork(N, 0, [&batcherCount](std::size_t, std::size_t) { ++batcherCount; });
+    }
+    if (N <= 16)
+        VisitSmallNetwork(N, 0, visit);
+    else if (N <= 32 && splitCount < batcherCount)
+        VisitSplitNetwork(N, visit);
+    else
+        VisitBatcherNetwork(N, 0, visit);
+}
+
+/**
+ * Number of comparators in the sorting network on N inputs.
+ */
+constexpr std::size_t CountComparators (std::size_t N) {
+    std::size_t count(0);
+    VisitNetwork(N, [&count](std::size_t, std::size_t) { ++count; });
+    return count;
+}
+
+/**
+ * Comparators of the sorting network on N inputs, in application order.
+ */
+template <std::size_t N>
+constexpr std::array<Comparator, CountComparators(N)> BuildComparators () {
+    std::array<Comparator, CountComparators(N)> comparators{};
+    std::size_t idx(0);
+    VisitNetwork(N, [&](std::size_t lo, std::size_t hi) {
+        comparators[idx].lo = lo;
+        comparators[idx].hi = hi;
+        ++idx;
+    });
+    return comparators;
+}
+
+/**
+ * Branchless compare-exchange: leave the smaller of a and b in a and the larger
+ * in b. Selecting between local copies lets compilers lower this to
+ * conditional moves without having to inline std::min/std::max first.
+ */
+inline void CompareExchange (long& a, long& b) {
+    const long x = a;
+    const long y = b;
+    a = x < y ? x : y;
+    b = x < y ? y : x;
+}
+
+/**
+ * Sorting network on N inputs, fully unrolled at compile time.
+ */
+template <std::size_t N>
+struct SortingNetwork {
+    static constexpr std::array<Comparator, CountComparators(N)> kComparators =
+        BuildComparators<N>();
+
+    // Sort the N elements starting at first
+    static void Sort (long* first) {
+        Apply(first, std::make_index_sequence<CountComparators(N)>{});
+    }
+
+private:
+    template <std::size_t... I>
+    static void Apply (long* first, std::index_sequence<I...>) {
+        (CompareExchange(first[kComparators[I].lo], first[kComparators[I].hi]), ...);
+        static_cast<void>(first);
+    }
+};
+
+using NetworkSortFn = void (*)(long*);
+
+template <std::size_t... N>
+constexpr std::array<NetworkSortFn, sizeof...(N)> MakeNetworkTable (std::index_sequence<N...>) {
+    return {{&SortingNetwork<N>::Sort...}};
+}
+
+/*
+ * Sorting network for each input size 0..kMaxNetworkSize, indexed by size
+ */
+inline constexpr std::array<NetworkSortFn, kMaxNetworkSize + 1> kSortingNetworks =
+    MakeNetworkTable(std::make_index_sequence<kMaxNetworkSize + 1>{});
+
+#endif // SORTINGNETWORKS_H_